@@ -11,6 +11,7 @@
 #include <mutex>
 #include <stdexcept>
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace Util {
@@ -19,6 +20,11 @@ namespace Util {
 		class BaseMap;
 	}
 
+    //! Forward declare the replication feed, which observes every change made to a board
+    namespace Replication {
+        class Publisher;
+    }
+
     //! Define alias' for the different types of event callbacks that can be defined
 	template<typename T> using EventKeyCallback = std::function<void(const std::string&)>;
 	template<typename T> using EventValueCallback = std::function<void(const T&)>;
@@ -52,6 +58,9 @@ namespace Util {
 		~Blackboard() = default;
 
 		private:
+        //! Allow the replication feed to attach its observers and take consistent snapshots
+        friend class Replication::Publisher;
+
         /*----------Variables----------*/
 
         //! Store a map of all of the different value types
@@ -59,9 +68,13 @@ namespace Util {
 
         //! Store a mutex for locking data when in use
 #ifndef BB_NO_THREAD
-		std::mutex mDataLock;
+		mutable std::mutex mDataLock;
 #endif
 
+        //! Store the observers for wipes that affect every type (Set by Replication::Publisher)
+        std::function<void(const std::string&)> mWipeKeyObserver;
+        std::function<void()> mWipeBoardObserver;
+
         //! Convert a template type into a unique ID value
         template<typename T> inline size_t templateToID() const;
 
@@ -105,7 +118,8 @@ namespace Util {
         class BaseMap { 
         protected:
             //! Set the Value map to be a friend of the blackboard to allow for construction/destruction of the object
-            friend class Blackboard;
+            friend class Util::Blackboard;
+            friend class Replication::Publisher;
 
             //! Provide virtual methods for wiping keyed information
             inline virtual void wipeKey(const std::string& pKey) = 0;
@@ -136,7 +150,8 @@ namespace Util {
         class ValueMap : BaseMap {
         protected:
             //! Set the Value map to be a friend of the blackboard to allow for construction/destruction of the object
-            friend class Blackboard;
+            friend class Util::Blackboard;
+            friend class Replication::Publisher;
 
             /*----------Variables----------*/
 
@@ -148,6 +163,11 @@ namespace Util {
             std::unordered_map<std::string, EventValueCallback<T>> mValueEvents;
             std::unordered_map<std::string, EventKeyValueCallback<T>> mPairEvents;
 
+            //! Store the observers that are told about every write/wipe of this type, regardless of key
+            //! or callback flags (Set by Replication::Publisher)
+            EventKeyValueCallback<T> mWriteObserver;
+            EventKeyCallback<T> mWipeObserver;
+
             /*----------Functions----------*/
 
             //! Privatise the constructor/destructor to prevent external use
@@ -261,6 +281,9 @@ namespace Util {
         //Copy the data value across
         map->mValues[pKey] = pValue;
 
+        //Report the change to the replication feed
+        if (map->mWriteObserver) map->mWriteObserver(pKey, map->mValues[pKey]);
+
         //Check event flag
         if (pRaiseCallbacks) {
             //Check for events to raise
@@ -298,6 +321,9 @@ namespace Util {
 		//Copy the data value across
 		map->mValues[pKey] = std::move(pValue);
 
+		//Report the change to the replication feed
+		if (map->mWriteObserver) map->mWriteObserver(pKey, map->mValues[pKey]);
+
 		//Check event flag
 		if (pRaiseCallbacks) {
 			//Check for events to raise
@@ -322,14 +348,16 @@ namespace Util {
     template<typename T>
     inline const T& Util::Blackboard::read(const std::string& pKey) const {
 
+#ifndef BB_NO_THREAD
         //Lock the data
         std::lock_guard<std::mutex> guard(mDataLock);
+#endif
 
         //Ensure the key for this type is supported
         size_t key = supportTypeRead<T>();
 
         //Cast the Value Map to the type of T
-		Util::Templates::ValueMap<T>* map = static_cast<Util::Templates::ValueMap<T>*>(mDataStorage[key].get());
+		Util::Templates::ValueMap<T>* map = static_cast<Util::Templates::ValueMap<T>*>(mDataStorage.at(key).get());
 
         //Return the value at the key location
         return map->mValues[pKey];
@@ -375,8 +403,10 @@ namespace Util {
     template<typename T>
     inline void Util::Blackboard::wipeTypeKey(const std::string& pKey) {
 
+#ifndef BB_NO_THREAD
         //Lock the data
         std::lock_guard<std::mutex> guard(mDataLock);
+#endif
 
         //Ensure the key for this type is supported
         size_t key = supportTypeRead<T>();
@@ -386,6 +416,9 @@ namespace Util {
 
         //Wipe the key from the value map
         map->wipeKey(pKey);
+
+        //Report the change to the replication feed
+        if (map->mWipeObserver) map->mWipeObserver(pKey);
     }
 
     /*
@@ -402,8 +435,10 @@ namespace Util {
     template<typename T>
     inline void Util::Blackboard::subscribe(const std::string& pKey, EventKeyCallback<T> pCb) {
 
+#ifndef BB_NO_THREAD
         //Lock the data
         std::lock_guard<std::mutex> guard(mDataLock);
+#endif
 
         //Ensure the key for this type is supported
         size_t key = supportTypeWrite<T>();
@@ -430,8 +465,10 @@ namespace Util {
     template<typename T>
     inline void Util::Blackboard::subscribe(const std::string& pKey, EventValueCallback<T> pCb) {
 
+#ifndef BB_NO_THREAD
         //Lock the data
         std::lock_guard<std::mutex> guard(mDataLock);
+#endif
 
         //Ensure the key for this type is supported
         size_t key = supportTypeWrite<T>();
@@ -485,8 +522,10 @@ namespace Util {
     template<typename T>
     inline void Util::Blackboard::unsubscribe(const std::string& pKey) {
 
+#ifndef BB_NO_THREAD
         //Lock the data
         std::lock_guard<std::mutex> guard(mDataLock);
+#endif
 
         //Ensure the key for this type is supported
         size_t key = supportTypeRead<T>();
@@ -588,6 +627,9 @@ void Util::Blackboard::wipeKey(const std::string& pKey) {
     //Loop through the different type collections
     for (auto& pair : mDataStorage)
         pair.second->wipeKey(pKey);
+
+    //Report the change to the replication feed
+    if (mWipeKeyObserver) mWipeKeyObserver(pKey);
 }
 
 /*
@@ -614,6 +656,9 @@ void Util::Blackboard::wipeBoard(bool pWipeCallbacks) {
         //Clear the callbacks
         if (pWipeCallbacks) pair.second->clearAllEvents();
     }
+
+    //Report the change to the replication feed
+    if (mWipeBoardObserver) mWipeBoardObserver();
 }
 
 /*
@@ -0,0 +1,219 @@
+/*
+ *      Exercises Replication.h: round trips over every transport, catching
+ *      up from a snapshot, a full ring resending and malformed frames.
+ *
+ *      Build and run on a POSIX system from this directory:
+ *      g++ -std=c++11 -pthread -I.. ReplicationTest.cpp -o ReplicationTest && ./ReplicationTest
+**/
+#include "Replication.h"
+#include <iostream>
+#include <string>
+
+#define CHECK(pCond) do { if (!(pCond)) { std::cerr << __FILE__ << ':' << __LINE__ << ": CHECK(" #pCond ") failed\n"; return false; } } while (0)
+
+struct Point {
+	int m_x = 0;
+	double m_y = 0;
+};
+
+//! Register the replicated types with the same tags on both sides
+static void registerTypes(Util::Replication::Publisher& pPub) {
+	pPub.replicate<int>(1);
+	pPub.replicate<std::string>(2);
+	pPub.replicate<Point>(3);
+}
+
+static void registerTypes(Util::Replication::Follower& pFol) {
+	pFol.replicate<int>(1);
+	pFol.replicate<std::string>(2);
+	pFol.replicate<Point>(3);
+}
+
+//! Alternate flushing and polling until the follower has everything
+static bool sync(Util::Replication::Publisher& pPub, Util::Replication::Follower& pFol,
+                 Util::Replication::Transport& pSend, Util::Replication::Transport& pReceive, uint64_t& pCursor) {
+	for (int i = 0; i < 100000 && (pFol.sequence() != pPub.sequence() || !pSend.drain()); ++i) {
+		pPub.flush(pSend, pCursor, 4);
+		pFol.poll(pReceive);
+	}
+	return pFol.sequence() == pPub.sequence();
+}
+
+//! Write, overwrite and wipe on the primary and check the replica matches
+static bool roundTrip(Util::Replication::Transport& pSend, Util::Replication::Transport& pReceive, bool pCompress) {
+	Util::Blackboard primary, replica;
+	Util::Replication::Publisher pub(primary, 64, pCompress);
+	Util::Replication::Follower fol(replica);
+	registerTypes(pub);
+	registerTypes(fol);
+
+	Point p;
+	p.m_x = 3;
+	p.m_y = 4.5;
+	for (int i = 0; i < 20; ++i) primary.write("count", i, i % 2 == 0);
+	primary.write<std::string>("name", std::string(300, 'a'));
+	primary.write("point", p);
+	primary.write("gone", 1);
+	primary.wipeTypeKey<int>("gone");
+	primary.write<std::string>("other", "x");
+	primary.wipeKey("other");
+
+	//A value larger than a pipe buffer must not block the primary
+	primary.write<std::string>("big", std::string(200 * 1024, 'b'));
+
+	uint64_t cursor = 0;
+	CHECK(sync(pub, fol, pSend, pReceive, cursor));
+	CHECK(replica.read<int>("count") == 19);
+	CHECK(replica.read<std::string>("name") == std::string(300, 'a'));
+	CHECK(replica.read<Point>("point").m_y == 4.5);
+	CHECK(replica.read<std::string>("big").size() == 200 * 1024);
+
+	//Wiped keys read back as default values
+	CHECK(replica.read<int>("gone") == 0);
+	CHECK(replica.read<std::string>("other").empty());
+
+	Util::Replication::LagMetrics lag = fol.lag();
+	CHECK(lag.recordsBehind == 0 && !lag.needsSnapshot && lag.snapshotsApplied == 0);
+	return true;
+}
+
+//! A follower joining after the log moved on starts from a snapshot
+static bool lateCatchUp() {
+	Util::Blackboard primary, replica;
+	primary.write("before", 7);
+	Util::Replication::Publisher pub(primary, 4);
+	registerTypes(pub);
+	for (int i = 0; i < 50; ++i) primary.write("k" + std::to_string(i % 5), i);
+
+	Util::Replication::Follower fol(replica);
+	registerTypes(fol);
+	replica.write("local", 1);
+
+	Util::Replication::RingBufferTransport ring;
+	uint64_t cursor = 0;
+	CHECK(sync(pub, fol, ring, ring, cursor));
+	CHECK(fol.lag().snapshotsApplied == 1);
+	CHECK(replica.read<int>("before") == 7 && replica.read<int>("k4") == 49);
+	CHECK(replica.read<int>("local") == 0);
+
+	//The delta tail follows the snapshot
+	primary.write("k0", -1);
+	CHECK(sync(pub, fol, ring, ring, cursor));
+	CHECK(replica.read<int>("k0") == -1 && fol.lag().snapshotsApplied == 1);
+	return true;
+}
+
+//! A full ring refuses frames and the next flush sends them again
+static bool fullRing() {
+	Util::Blackboard primary, replica;
+	Util::Replication::Publisher pub(primary);
+	Util::Replication::Follower fol(replica);
+	registerTypes(pub);
+	registerTypes(fol);
+
+	Util::Replication::RingBufferTransport ring(2);
+	uint64_t cursor = 0;
+	for (int i = 0; i < 10; ++i) primary.write("k" + std::to_string(i), i);
+	CHECK(pub.flush(ring, cursor, 2) == 2);
+	CHECK(cursor == 4);
+
+	CHECK(fol.poll(ring) == 2);
+	CHECK(pub.flush(ring, cursor, 2) == 2);
+	CHECK(fol.poll(ring) == 2);
+	CHECK(pub.flush(ring, cursor, 2) == 1);
+	CHECK(fol.poll(ring) == 1);
+	CHECK(fol.sequence() == 10 && replica.read<int>("k9") == 9);
+	return true;
+}
+
+//! A delta that leaves a gap is rejected and reported until a snapshot arrives
+static bool gap() {
+	Util::Blackboard primary, replica;
+	Util::Replication::Publisher pub(primary);
+	Util::Replication::Follower fol(replica);
+	registerTypes(pub);
+	registerTypes(fol);
+
+	Util::Replication::RingBufferTransport ring;
+	primary.write("a", 1);
+	primary.write("a", 2);
+	uint64_t cursor = 1;
+	CHECK(pub.flush(ring, cursor) == 1);
+	CHECK(fol.poll(ring) == 0);
+
+	Util::Replication::LagMetrics lag = fol.lag();
+	CHECK(lag.needsSnapshot && fol.needsSnapshot());
+	CHECK(lag.primarySequence == 2 && lag.recordsBehind == 2 && lag.framesRejected == 1);
+
+	uint64_t sequence;
+	CHECK(ring.send(pub.snapshot(sequence)));
+	cursor = sequence;
+	CHECK(fol.poll(ring) == 1);
+	CHECK(!fol.needsSnapshot() && replica.read<int>("a") == 2 && fol.lag().recordsBehind == 0);
+	return true;
+}
+
+//! Malformed frames throw and leave the replica untouched
+static bool malformed() {
+	Util::Blackboard primary, replica;
+	Util::Replication::Publisher pub(primary, 64, true);
+	Util::Replication::Follower fol(replica);
+	registerTypes(fol);
+	pub.replicate<int>(1);
+	pub.replicate<float>(9);
+
+	primary.write("a", 1);
+	std::string frame;
+	CHECK(pub.deltasSince(0, frame) == 1);
+	CHECK(fol.apply(frame));
+
+	//Truncated frames and unknown frame kinds
+	int thrown = 0;
+	for (std::size_t size = 0; size < frame.size(); ++size) {
+		try { fol.apply(frame.substr(0, size)); }
+		catch (const std::runtime_error&) { ++thrown; }
+	}
+	CHECK(thrown == static_cast<int>(frame.size()));
+	std::string bad = frame;
+	bad[0] = 'X';
+	try { fol.apply(bad); CHECK(false); }
+	catch (const std::runtime_error&) {}
+
+	//A compressed size the payload could not produce
+	std::string huge;
+	huge.push_back(static_cast<char>(Util::Replication::FrameKind::Delta));
+	huge.push_back(static_cast<char>(Util::Replication::FRAME_COMPRESSED));
+	for (int i = 0; i < 4; ++i) Util::Replication::Detail::writeVarint(huge, 1);
+	Util::Replication::Detail::writeVarint(huge, uint64_t(1) << 60);
+	huge.append("\x01\x01\x02", 3);
+	try { fol.apply(huge); CHECK(false); }
+	catch (const std::runtime_error&) {}
+
+	//A snapshot holding an unregistered type must not wipe the replica
+	primary.write("f", 1.5f);
+	try { fol.apply(pub.snapshot()); CHECK(false); }
+	catch (const std::invalid_argument&) {}
+	CHECK(replica.read<int>("a") == 1 && fol.sequence() == 1);
+	return true;
+}
+
+int main() {
+	bool ok = true;
+	for (int compress = 0; compress < 2; ++compress) {
+		Util::Replication::RingBufferTransport ring;
+		ok &= roundTrip(ring, ring, compress != 0);
+
+		auto pipe = Util::Replication::StreamTransport::pipe();
+		ok &= roundTrip(*pipe.first, *pipe.second, compress != 0);
+
+		auto sockets = Util::Replication::StreamTransport::socketPair();
+		ok &= roundTrip(*sockets.first, *sockets.second, compress != 0);
+	}
+	ok &= lateCatchUp();
+	ok &= fullRing();
+	ok &= gap();
+	ok &= malformed();
+
+	std::cout << (ok ? "All replication checks passed\n" : "Replication checks failed\n");
+	return ok ? 0 : 1;
+}
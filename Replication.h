@@ -0,0 +1,1173 @@
+#ifndef REPLICATION_H
+#define REPLICATION_H
+
+#include "Blackboard.h"
+
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <sys/socket.h>
+	#include <sys/un.h>
+#endif
+
+namespace Util {
+    namespace Replication {
+        //! Identify the kind of change a single delta record describes
+        enum class Op : uint8_t {
+            Write = 1,
+            WipeTypeKey = 2,
+            WipeKey = 3,
+            WipeBoard = 4
+        };
+
+        //! Identify the kind of frame sent down a Transport
+        enum class FrameKind : uint8_t {
+            Delta = 'D',
+            Snapshot = 'S'
+        };
+
+        //! Frame header flag marking a PackBits compressed payload
+        const uint8_t FRAME_COMPRESSED = 0x01;
+
+        /*
+         *      Name: Codec
+         *      Author: Bricktricker
+         *      Created: 18/10/2026
+         *
+         *      Purpose:
+         *      Convert a value type to and from the bytes sent to
+         *      follower blackboards. Trivially copyable types and
+         *      std::string are supported out of the box, any other
+         *      replicated type needs a specialisation providing
+         *      the same two static functions.
+         *
+         *      Warning:
+         *      Pointers are not supported by default, their addresses
+         *      mean nothing to a follower in another process. Structs
+         *      holding pointers still match the default, give them a
+         *      specialisation that sends what they point to instead.
+        **/
+        template<typename T, typename = void>
+        struct Codec;
+
+        template<typename T>
+        struct Codec<T, typename std::enable_if<std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value && !std::is_member_pointer<T>::value>::type> {
+            static void encode(const T& pValue, std::string& pOut) {
+                pOut.append(reinterpret_cast<const char*>(&pValue), sizeof(T));
+            }
+
+            static T decode(const char* pData, std::size_t pSize) {
+                if (pSize != sizeof(T)) throw std::runtime_error("Replicated value has the wrong size");
+                T value;
+                std::memcpy(&value, pData, sizeof(T));
+                return value;
+            }
+        };
+
+        template<>
+        struct Codec<std::string> {
+            static void encode(const std::string& pValue, std::string& pOut) {
+                pOut.append(pValue);
+            }
+
+            static std::string decode(const char* pData, std::size_t pSize) {
+                return std::string(pData, pSize);
+            }
+        };
+
+        namespace Detail {
+            //! Append an unsigned LEB128 encoded integer
+            inline void writeVarint(std::string& pOut, uint64_t pValue) {
+                while (pValue >= 0x80) {
+                    pOut.push_back(static_cast<char>((pValue & 0x7F) | 0x80));
+                    pValue >>= 7;
+                }
+                pOut.push_back(static_cast<char>(pValue));
+            }
+
+            //! Append a length prefixed byte string
+            inline void writeBytes(std::string& pOut, const std::string& pBytes) {
+                writeVarint(pOut, pBytes.size());
+                pOut.append(pBytes);
+            }
+
+            //! Get the current wall clock time in microseconds, used to measure replication delay
+            inline uint64_t nowMicros() {
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            }
+
+            /*
+             *      Name: Reader
+             *      Author: Bricktricker
+             *      Created: 18/10/2026
+             *
+             *      Purpose:
+             *      Walk a received frame, throwing a runtime_error
+             *      instead of reading past the end of malformed data
+            **/
+            class Reader {
+                const char* mData;
+                std::size_t mSize;
+                std::size_t mPos = 0;
+
+            public:
+                Reader(const char* pData, std::size_t pSize) : mData(pData), mSize(pSize) {}
+
+                bool done() const { return mPos == mSize; }
+
+                uint8_t byte() {
+                    if (mPos >= mSize) throw std::runtime_error("Truncated replication frame");
+                    return static_cast<uint8_t>(mData[mPos++]);
+                }
+
+                uint64_t varint() {
+                    uint64_t value = 0;
+                    for (int shift = 0; shift < 64; shift += 7) {
+                        uint8_t b = byte();
+                        value |= static_cast<uint64_t>(b & 0x7F) << shift;
+                        if (!(b & 0x80)) return value;
+                    }
+                    throw std::runtime_error("Malformed varint in replication frame");
+                }
+
+                //! Read a length prefixed byte string, returning a pointer into the frame
+                const char* bytes(std::size_t& pSize) {
+                    pSize = static_cast<std::size_t>(varint());
+                    if (pSize > mSize - mPos) throw std::runtime_error("Truncated replication frame");
+                    const char* start = mData + mPos;
+                    mPos += pSize;
+                    return start;
+                }
+
+                std::string string() {
+                    std::size_t size;
+                    const char* start = bytes(size);
+                    return std::string(start, size);
+                }
+
+                //! Get the unread remainder of the frame
+                const char* rest(std::size_t& pSize) {
+                    pSize = mSize - mPos;
+                    const char* start = mData + mPos;
+                    mPos = mSize;
+                    return start;
+                }
+            };
+
+            /*
+                packBits - Run length encode a payload. Encoded values, mostly small integers
+                           and zero padded structs, are dominated by runs of repeated bytes
+                Author: Bricktricker
+                Created: 18/10/2026
+
+                param[in] pData - The bytes to compress
+                param[in] pSize - The number of bytes to compress
+
+                return std::string - Returns the PackBits encoded data
+            */
+            inline std::string packBits(const char* pData, std::size_t pSize) {
+                std::string out;
+                std::size_t i = 0;
+                while (i < pSize) {
+                    //Measure the run starting at i
+                    std::size_t run = 1;
+                    while (i + run < pSize && run < 128 && pData[i + run] == pData[i]) ++run;
+
+                    if (run >= 3) {
+                        out.push_back(static_cast<char>(257 - run));
+                        out.push_back(pData[i]);
+                        i += run;
+                        continue;
+                    }
+
+                    //Collect literals until the next run worth encoding
+                    std::size_t start = i;
+                    while (i < pSize && i - start < 128) {
+                        if (i + 2 < pSize && pData[i] == pData[i + 1] && pData[i] == pData[i + 2]) break;
+                        ++i;
+                    }
+                    out.push_back(static_cast<char>(i - start - 1));
+                    out.append(pData + start, i - start);
+                }
+                return out;
+            }
+
+            /*
+                unpackBits - Reverse packBits
+                Author: Bricktricker
+                Created: 18/10/2026
+
+                param[in] pData - The PackBits encoded bytes
+                param[in] pSize - The number of encoded bytes
+                param[in] pExpected - The size of the original payload, as read from the frame
+
+                return std::string - Returns the decoded payload
+            */
+            inline std::string unpackBits(const char* pData, std::size_t pSize, uint64_t pExpected) {
+                //A run of 128 bytes packs into 2, anything larger than that ratio is corrupt
+                if (pExpected > static_cast<uint64_t>(pSize) * 64) throw std::runtime_error("Compressed payload has the wrong size");
+
+                std::string out;
+                out.reserve(static_cast<std::size_t>(pExpected));
+                std::size_t i = 0;
+                while (i < pSize) {
+                    uint8_t header = static_cast<uint8_t>(pData[i++]);
+                    if (header < 128) {
+                        std::size_t count = header + 1u;
+                        if (count > pSize - i) throw std::runtime_error("Truncated compressed payload");
+                        out.append(pData + i, count);
+                        i += count;
+                    } else if (header > 128) {
+                        if (i >= pSize) throw std::runtime_error("Truncated compressed payload");
+                        out.append(257u - header, pData[i++]);
+                    }
+                    if (out.size() > pExpected) break;
+                }
+                if (out.size() != pExpected) throw std::runtime_error("Compressed payload has the wrong size");
+                return out;
+            }
+
+            /*
+                buildFrame - Wrap a batch of records in a frame header
+                Author: Bricktricker
+                Created: 18/10/2026
+
+                param[in] pKind - Delta or Snapshot
+                param[in] pSequence - Delta: the sequence of the first record. Snapshot: the sequence the snapshot reflects
+                param[in] pHead - The newest sequence on the primary when the frame was built
+                param[in] pCount - The number of records in the payload
+                param[in] pPayload - The concatenated records
+                param[in] pCompress - Flags if the payload should be compressed when that makes it smaller
+
+                return std::string - Returns the complete frame
+            */
+            inline std::string buildFrame(FrameKind pKind, uint64_t pSequence, uint64_t pHead, uint64_t pCount, const std::string& pPayload, bool pCompress) {
+                std::string packed;
+                if (pCompress) packed = packBits(pPayload.data(), pPayload.size());
+                bool compressed = pCompress && packed.size() < pPayload.size();
+
+                std::string frame;
+                frame.push_back(static_cast<char>(pKind));
+                frame.push_back(static_cast<char>(compressed ? FRAME_COMPRESSED : 0));
+                writeVarint(frame, pSequence);
+                writeVarint(frame, pHead);
+                writeVarint(frame, nowMicros());
+                writeVarint(frame, pCount);
+                if (compressed) {
+                    writeVarint(frame, pPayload.size());
+                    frame.append(packed);
+                } else frame.append(pPayload);
+                return frame;
+            }
+        }
+
+        /*
+         *      Name: Transport
+         *      Author: Bricktricker
+         *      Created: 18/10/2026
+         *
+         *      Purpose:
+         *      Carry frames from a Publisher to a Follower. Frames
+         *      must arrive whole and in order. Neither side blocks.
+        **/
+        class Transport {
+        public:
+            virtual ~Transport() = default;
+
+            //! Queue a frame for the other side without blocking, returns false if it could not be accepted
+            //! right now, in which case it should be sent again later
+            virtual bool send(const std::string& pFrame) = 0;
+
+            //! Take the next frame without blocking, returns false if none is available yet
+            virtual bool receive(std::string& pFrame) = 0;
+
+            //! Push out any accepted frame that was only partly sent, returns true once nothing is left
+            virtual bool drain() { return true; }
+        };
+
+        /*
+         *      Name: RingBufferTransport
+         *      Author: Bricktricker
+         *      Created: 18/10/2026
+         *
+         *      Purpose:
+         *      Pass frames between threads of the same process
+         *      through a fixed size ring. A full ring rejects
+         *      frames, leaving the publisher's cursor untouched so
+         *      they are sent again on the next flush.
+        **/
+        class RingBufferTransport : public Transport {
+            std::vector<std::string> mSlots;
+            std::size_t mHead = 0;
+            std::size_t mCount = 0;
+
+#ifndef BB_NO_THREAD
+            std::mutex mLock;
+#endif
+
+        public:
+            explicit RingBufferTransport(std::size_t pCapacity = 64) : mSlots(pCapacity ? pCapacity : 1) {}
+
+            bool send(const std::string& pFrame) override {
+#ifndef BB_NO_THREAD
+                std::lock_guard<std::mutex> guard(mLock);
+#endif
+                if (mCount == mSlots.size()) return false;
+                mSlots[(mHead + mCount) % mSlots.size()] = pFrame;
+                ++mCount;
+                return true;
+            }
+
+            bool receive(std::string& pFrame) override {
+#ifndef BB_NO_THREAD
+                std::lock_guard<std::mutex> guard(mLock);
+#endif
+                if (!mCount) return false;
+                pFrame.swap(mSlots[mHead]);
+                mSlots[mHead].clear();
+                mHead = (mHead + 1) % mSlots.size();
+                --mCount;
+                return true;
+            }
+        };
+
+#ifndef _WIN32
+        /*
+         *      Name: StreamTransport
+         *      Author: Bricktricker
+         *      Created: 18/10/2026
+         *
+         *      Purpose:
+         *      Pass frames over a pipe or Unix socket, for replicas
+         *      living in child or unrelated processes. Each frame
+         *      is prefixed with its length as 4 little endian bytes.
+         *
+         *      The writing descriptor is switched to non blocking
+         *      mode. A frame the stream only partly took is kept and
+         *      finished by later send/drain calls, further frames are
+         *      refused until it is out.
+         *
+         *      Warning:
+         *      Writing to a pipe whose reader has exited raises
+         *      SIGPIPE, ignore it if followers may go away.
+        **/
+        class StreamTransport : public Transport {
+            int mReadFd;
+            int mWriteFd;
+            bool mSocket;
+            bool mOpen = true;
+            std::string mBuffer;
+            std::string mPending;
+
+            //! Write as much of mPending as the stream takes right now
+            void writePending() {
+                std::size_t written = 0;
+                while (mOpen && written < mPending.size()) {
+                    ssize_t result;
+#ifdef MSG_NOSIGNAL
+                    if (mSocket) result = ::send(mWriteFd, mPending.data() + written, mPending.size() - written, MSG_NOSIGNAL);
+                    else
+#endif
+                    result = ::write(mWriteFd, mPending.data() + written, mPending.size() - written);
+
+                    if (result < 0) {
+                        if (errno == EINTR) continue;
+                        if (errno != EAGAIN && errno != EWOULDBLOCK) mOpen = false;
+                        break;
+                    }
+                    written += static_cast<std::size_t>(result);
+                }
+                mPending.erase(0, written);
+            }
+
+            //! Move a complete frame out of the receive buffer if one has arrived
+            bool extract(std::string& pFrame) {
+                if (mBuffer.size() < 4) return false;
+                const unsigned char* header = reinterpret_cast<const unsigned char*>(mBuffer.data());
+                std::size_t size = static_cast<std::size_t>(header[0]) | static_cast<std::size_t>(header[1]) << 8 |
+                                   static_cast<std::size_t>(header[2]) << 16 | static_cast<std::size_t>(header[3]) << 24;
+                if (mBuffer.size() - 4 < size) return false;
+                pFrame.assign(mBuffer, 4, size);
+                mBuffer.erase(0, 4 + size);
+                return true;
+            }
+
+            static std::runtime_error error(const char* pWhat) {
+                return std::runtime_error(std::string(pWhat) + ": " + std::strerror(errno));
+            }
+
+            static sockaddr_un address(const std::string& pPath) {
+                sockaddr_un addr;
+                std::memset(&addr, 0, sizeof(addr));
+                addr.sun_family = AF_UNIX;
+                if (pPath.size() >= sizeof(addr.sun_path)) throw std::invalid_argument("Unix socket path is too long");
+                std::memcpy(addr.sun_path, pPath.c_str(), pPath.size() + 1);
+                return addr;
+            }
+
+        public:
+            //! Take ownership of already opened descriptors, pass -1 for a direction that is not used
+            StreamTransport(int pReadFd, int pWriteFd, bool pSocket = false) : mReadFd(pReadFd), mWriteFd(pWriteFd), mSocket(pSocket) {
+                if (mWriteFd >= 0) ::fcntl(mWriteFd, F_SETFL, ::fcntl(mWriteFd, F_GETFL) | O_NONBLOCK);
+            }
+
+            ~StreamTransport() override {
+                if (mReadFd >= 0) ::close(mReadFd);
+                if (mWriteFd >= 0 && mWriteFd != mReadFd) ::close(mWriteFd);
+            }
+
+            StreamTransport(const StreamTransport&) = delete;
+            StreamTransport& operator=(const StreamTransport&) = delete;
+
+            //! Returns false once the other side has closed the stream or it failed
+            bool isOpen() const { return mOpen; }
+
+            bool send(const std::string& pFrame) override {
+                if (!mOpen || mWriteFd < 0) return false;
+                if (pFrame.size() > 0xFFFFFFFFu) throw std::length_error("Replication frame is too large");
+
+                //Finish the previous frame before accepting another
+                if (!drain()) return false;
+
+                mPending.reserve(pFrame.size() + 4);
+                for (int i = 0; i < 4; ++i) mPending.push_back(static_cast<char>((pFrame.size() >> (8 * i)) & 0xFF));
+                mPending.append(pFrame);
+                std::size_t size = mPending.size();
+                writePending();
+
+                //Refuse the frame if none of it went out, it is sent again later
+                if (mPending.size() == size) {
+                    mPending.clear();
+                    return false;
+                }
+                return true;
+            }
+
+            bool drain() override {
+                if (!mPending.empty() && mOpen) writePending();
+                return mPending.empty();
+            }
+
+            bool receive(std::string& pFrame) override {
+                if (extract(pFrame)) return true;
+                if (!mOpen || mReadFd < 0) return false;
+
+                //Read whatever is already waiting, stopping as soon as a frame is complete
+                char chunk[65536];
+                pollfd fd = { mReadFd, POLLIN, 0 };
+                while (::poll(&fd, 1, 0) > 0) {
+                    ssize_t result = ::read(mReadFd, chunk, sizeof(chunk));
+                    if (result < 0 && errno == EINTR) continue;
+                    if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+                    if (result <= 0) {
+                        mOpen = false;
+                        break;
+                    }
+                    mBuffer.append(chunk, static_cast<std::size_t>(result));
+                    if (extract(pFrame)) return true;
+                }
+                return false;
+            }
+
+            //! Open a pipe, returning the writing end first and the reading end second
+            static std::pair<std::unique_ptr<StreamTransport>, std::unique_ptr<StreamTransport>> pipe() {
+                int fds[2];
+                if (::pipe(fds) != 0) throw error("pipe");
+                return std::make_pair(std::unique_ptr<StreamTransport>(new StreamTransport(-1, fds[1])),
+                                      std::unique_ptr<StreamTransport>(new StreamTransport(fds[0], -1)));
+            }
+
+            //! Open a pair of connected Unix sockets
+            static std::pair<std::unique_ptr<StreamTransport>, std::unique_ptr<StreamTransport>> socketPair() {
+                int fds[2];
+                if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) throw error("socketpair");
+                return std::make_pair(std::unique_ptr<StreamTransport>(new StreamTransport(fds[0], fds[0], true)),
+                                      std::unique_ptr<StreamTransport>(new StreamTransport(fds[1], fds[1], true)));
+            }
+
+            //! Connect to a Unix socket listening at pPath
+            static std::unique_ptr<StreamTransport> connect(const std::string& pPath) {
+                sockaddr_un addr = address(pPath);
+                int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (fd < 0) throw error("socket");
+                if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                    std::runtime_error e = error("connect");
+                    ::close(fd);
+                    throw e;
+                }
+                return std::unique_ptr<StreamTransport>(new StreamTransport(fd, fd, true));
+            }
+
+            //! Listen on a Unix socket at pPath and block until a single peer connects
+            static std::unique_ptr<StreamTransport> accept(const std::string& pPath) {
+                sockaddr_un addr = address(pPath);
+                int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (listener < 0) throw error("socket");
+                ::unlink(pPath.c_str());
+                if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listener, 1) != 0) {
+                    std::runtime_error e = error("bind");
+                    ::close(listener);
+                    throw e;
+                }
+
+                int fd;
+                do fd = ::accept(listener, nullptr, nullptr); while (fd < 0 && errno == EINTR);
+                if (fd < 0) {
+                    std::runtime_error e = error("accept");
+                    ::close(listener);
+                    ::unlink(pPath.c_str());
+                    throw e;
+                }
+                ::close(listener);
+                ::unlink(pPath.c_str());
+                return std::unique_ptr<StreamTransport>(new StreamTransport(fd, fd, true));
+            }
+        };
+#endif
+
+        /*
+         *      Name: Publisher
+         *      Author: Bricktricker
+         *      Created: 18/10/2026
+         *
+         *      Purpose:
+         *      Record every write and wipe made to a Blackboard as a
+         *      compact binary delta, numbered by a sequence that
+         *      starts at 1. The newest deltas are kept in a bounded
+         *      log so followers can catch up from their last applied
+         *      sequence, followers that fell out of the log are sent
+         *      a snapshot first.
+         *
+         *      Warning:
+         *      Only types registered with replicate<T> are recorded.
+         *      Values changed through the reference returned by
+         *      Blackboard::read are not seen, write them back instead.
+         *      The Publisher must not outlive the Blackboard.
+        **/
+        class Publisher {
+        public:
+            explicit Publisher(Blackboard& pBoard, std::size_t pLogCapacity = 4096, bool pCompress = false);
+            ~Publisher();
+
+            Publisher(const Publisher&) = delete;
+            Publisher& operator=(const Publisher&) = delete;
+
+            //! Start recording changes to values of type T, identified on the wire by pTag
+            template<typename T> void replicate(uint32_t pTag);
+
+            //! Get the sequence of the newest recorded change
+            uint64_t sequence() const;
+
+            //! Build frames for followers
+            std::size_t deltasSince(uint64_t pCursor, std::string& pFrame, std::size_t pMaxRecords = 256) const;
+            std::string snapshot() const;
+            std::string snapshot(uint64_t& pSequence) const;
+
+            //! Send everything a follower at pCursor is missing down a transport, without blocking
+            std::size_t flush(Transport& pTransport, uint64_t& pCursor, std::size_t pMaxRecords = 256);
+
+        private:
+            /*----------Variables----------*/
+
+            //! Store the board being observed
+            Blackboard& mBoard;
+
+            //! Store the log settings
+            std::size_t mCapacity;
+            bool mCompress;
+
+            //! Store the newest sequence and the encoded records leading up to it, oldest first
+            uint64_t mSequence = 0;
+            std::deque<std::string> mLog;
+
+            //! Store the wire tags in use and, per replicated type, how to encode all its values and detach its observers
+            std::unordered_map<uint32_t, size_t> mTags;
+            std::vector<std::function<uint64_t(std::string&)>> mSnapshotters;
+            std::vector<std::function<void()>> mDetachers;
+
+            //! Store a mutex guarding the log, always taken after the board's lock
+#ifndef BB_NO_THREAD
+            mutable std::mutex mLogLock;
+#endif
+
+            /*----------Functions----------*/
+
+            void append(std::string&& pRecord);
+        };
+
+        //! Describe how far a Follower trails its Publisher
+        struct LagMetrics {
+            //! The last sequence applied locally and the primary's sequence when the newest frame was built
+            uint64_t appliedSequence = 0;
+            uint64_t primarySequence = 0;
+            uint64_t recordsBehind = 0;
+
+            //! The time between the newest frame being built and applied
+            std::chrono::microseconds delay = std::chrono::microseconds(0);
+
+            //! Set when a delta frame left a gap, the follower applies nothing more until it receives a snapshot
+            bool needsSnapshot = false;
+
+            //! Running totals
+            uint64_t framesApplied = 0;
+            uint64_t framesRejected = 0;
+            uint64_t recordsApplied = 0;
+            uint64_t snapshotsApplied = 0;
+            uint64_t bytesReceived = 0;
+        };
+
+        /*
+         *      Name: Follower
+         *      Author: Bricktricker
+         *      Created: 18/10/2026
+         *
+         *      Purpose:
+         *      Apply the frames produced by a Publisher to a local
+         *      Blackboard. Snapshots wipe the board first, so it
+         *      should only hold replicated data.
+         *
+         *      A delta frame that does not continue from the applied
+         *      sequence is rejected and needsSnapshot is set. Resync
+         *      the follower by sending it Publisher::snapshot and
+         *      flushing from the sequence that snapshot reflects.
+         *
+         *      Warning:
+         *      The handlers registered by replicate<T> point back at
+         *      the Follower, so it can not be copied or moved and must
+         *      stay at the same address once types are registered.
+        **/
+        class Follower {
+        public:
+            explicit Follower(Blackboard& pBoard, bool pRaiseCallbacks = true) : mBoard(pBoard), mRaiseCallbacks(pRaiseCallbacks) {}
+
+            Follower(const Follower&) = delete;
+            Follower& operator=(const Follower&) = delete;
+
+            //! Accept values of type T sent under pTag
+            template<typename T> void replicate(uint32_t pTag);
+
+            //! Apply received frames
+            bool apply(const std::string& pFrame);
+            std::size_t poll(Transport& pTransport);
+
+            //! Get the replication progress
+            uint64_t sequence() const;
+            bool needsSnapshot() const;
+            LagMetrics lag() const;
+
+        private:
+            /*----------Variables----------*/
+
+            //! Store the board being written to
+            Blackboard& mBoard;
+            bool mRaiseCallbacks;
+
+            //! Store how to write and wipe each replicated type. Writes decode their value up front and
+            //! return the change, so a frame is fully checked before the board is touched
+            struct Handler {
+                std::function<std::function<void()>(const std::string&, const char*, std::size_t)> write;
+                std::function<void(const std::string&)> wipe;
+            };
+            std::unordered_map<uint32_t, Handler> mHandlers;
+
+            //! Store the replication progress
+            LagMetrics mMetrics;
+
+            //! Store a mutex guarding the metrics so lag can be read from other threads
+#ifndef BB_NO_THREAD
+            mutable std::mutex mMetricsLock;
+#endif
+
+            /*----------Functions----------*/
+
+            const Handler& handler(uint64_t pTag) const;
+        };
+
+        #pragma region Template Definitions
+        /*
+            Publisher : replicate<T> - Start recording changes to values of type T. Values already on the
+                                       board are recorded as writes so followers receive them too
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            template T - A type with a Codec
+
+            param[in] pTag - A number identifying T on the wire, followers must use the same one
+        */
+        template<typename T>
+        inline void Publisher::replicate(uint32_t pTag) {
+
+#ifndef BB_NO_THREAD
+            //Lock the board so no change slips in between the existing values and the observer
+            std::lock_guard<std::mutex> guard(mBoard.mDataLock);
+#endif
+
+            //Ensure the key for this type is supported
+            size_t key = mBoard.supportTypeWrite<T>();
+            if (mTags.find(pTag) != mTags.end()) throw std::invalid_argument("Replication tag already in use");
+            for (auto& pair : mTags)
+                if (pair.second == key) throw std::invalid_argument("Type is already replicated");
+            mTags[pTag] = key;
+
+            //Cast the Value Map to the type of T, maps live as long as the board so the pointer stays valid
+            Util::Templates::ValueMap<T>* map = static_cast<Util::Templates::ValueMap<T>*>(mBoard.mDataStorage[key].get());
+
+            auto encodeWrite = [pTag](std::string& pOut, const std::string& pKey, const T& pValue) {
+                pOut.push_back(static_cast<char>(Op::Write));
+                Detail::writeVarint(pOut, pTag);
+                Detail::writeBytes(pOut, pKey);
+                std::string value;
+                Codec<T>::encode(pValue, value);
+                Detail::writeBytes(pOut, value);
+            };
+
+            //Record the values already stored
+            for (auto& pair : map->mValues) {
+                std::string record;
+                encodeWrite(record, pair.first, pair.second);
+                append(std::move(record));
+            }
+
+            //Attach the observers
+            map->mWriteObserver = [this, encodeWrite](const std::string& pKey, const T& pValue) {
+                std::string record;
+                encodeWrite(record, pKey, pValue);
+                append(std::move(record));
+            };
+            map->mWipeObserver = [this, pTag](const std::string& pKey) {
+                std::string record;
+                record.push_back(static_cast<char>(Op::WipeTypeKey));
+                Detail::writeVarint(record, pTag);
+                Detail::writeBytes(record, pKey);
+                append(std::move(record));
+            };
+
+            //Remember how to snapshot and detach this type
+            mSnapshotters.push_back([map, encodeWrite](std::string& pOut) {
+                for (auto& pair : map->mValues) encodeWrite(pOut, pair.first, pair.second);
+                return static_cast<uint64_t>(map->mValues.size());
+            });
+            mDetachers.push_back([map]() {
+                map->mWriteObserver = nullptr;
+                map->mWipeObserver = nullptr;
+            });
+        }
+
+        /*
+            Follower : replicate<T> - Accept values of type T sent under pTag
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            template T - A type with a Codec
+
+            param[in] pTag - The number the Publisher registered T under
+        */
+        template<typename T>
+        inline void Follower::replicate(uint32_t pTag) {
+            if (mHandlers.find(pTag) != mHandlers.end()) throw std::invalid_argument("Replication tag already in use");
+
+            Handler& handler = mHandlers[pTag];
+            handler.write = [this](const std::string& pKey, const char* pData, std::size_t pSize) {
+                std::shared_ptr<T> value = std::make_shared<T>(Codec<T>::decode(pData, pSize));
+                return std::function<void()>([this, pKey, value]() { mBoard.write<T>(pKey, std::move(*value), mRaiseCallbacks); });
+            };
+            handler.wipe = [this](const std::string& pKey) {
+                //Nothing to wipe if this type was never written locally
+                try { mBoard.wipeTypeKey<T>(pKey); }
+                catch (const std::invalid_argument&) {}
+            };
+        }
+        #pragma endregion
+
+        #pragma region Publisher
+        /*
+            Publisher : Constructor - Attach to a board, recording wipes straight away
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pBoard - The board to observe
+            param[in] pLogCapacity - The number of records kept for followers to catch up from (Default 4096)
+            param[in] pCompress - Flags if frames should be compressed (Default false)
+        */
+        inline Publisher::Publisher(Blackboard& pBoard, std::size_t pLogCapacity, bool pCompress)
+            : mBoard(pBoard), mCapacity(pLogCapacity ? pLogCapacity : 1), mCompress(pCompress) {
+
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mBoard.mDataLock);
+#endif
+            if (mBoard.mWipeKeyObserver || mBoard.mWipeBoardObserver) throw std::logic_error("Blackboard already has a Publisher");
+
+            mBoard.mWipeKeyObserver = [this](const std::string& pKey) {
+                std::string record;
+                record.push_back(static_cast<char>(Op::WipeKey));
+                Detail::writeBytes(record, pKey);
+                append(std::move(record));
+            };
+            mBoard.mWipeBoardObserver = [this]() {
+                append(std::string(1, static_cast<char>(Op::WipeBoard)));
+            };
+        }
+
+        /*
+            Publisher : Destructor - Detach all observers from the board
+            Author: Bricktricker
+            Created: 18/10/2026
+        */
+        inline Publisher::~Publisher() {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mBoard.mDataLock);
+#endif
+            mBoard.mWipeKeyObserver = nullptr;
+            mBoard.mWipeBoardObserver = nullptr;
+            for (auto& detach : mDetachers) detach();
+        }
+
+        /*
+            Publisher : append - Add a record to the log, dropping the oldest once it is full.
+                                 Called with the board's lock held
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pRecord - The encoded record
+        */
+        inline void Publisher::append(std::string&& pRecord) {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mLogLock);
+#endif
+            ++mSequence;
+            mLog.push_back(std::move(pRecord));
+            if (mLog.size() > mCapacity) mLog.pop_front();
+        }
+
+        /*
+            Publisher : sequence - Get the sequence of the newest recorded change
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            return uint64_t - Returns the sequence, 0 if nothing was recorded yet
+        */
+        inline uint64_t Publisher::sequence() const {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mLogLock);
+#endif
+            return mSequence;
+        }
+
+        /*
+            Publisher : deltasSince - Build a delta frame of the records after pCursor. Throws an out_of_range
+                                      exception if those records have already left the log
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pCursor - The last sequence the follower applied
+            param[out] pFrame - Receives the frame
+            param[in] pMaxRecords - The most records to put in one frame (Default 256)
+
+            return std::size_t - Returns the number of records in the frame, 0 if the follower is up to date
+        */
+        inline std::size_t Publisher::deltasSince(uint64_t pCursor, std::string& pFrame, std::size_t pMaxRecords) const {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mLogLock);
+#endif
+            uint64_t oldest = mSequence - mLog.size();
+            if (pCursor < oldest || pCursor > mSequence) throw std::out_of_range("Cursor is outside the replication log");
+
+            std::size_t count = static_cast<std::size_t>(mSequence - pCursor);
+            if (count > pMaxRecords) count = pMaxRecords ? pMaxRecords : 1;
+            if (!count) return 0;
+
+            std::string payload;
+            std::size_t first = static_cast<std::size_t>(pCursor - oldest);
+            for (std::size_t i = first; i < first + count; ++i) payload.append(mLog[i]);
+
+            pFrame = Detail::buildFrame(FrameKind::Delta, pCursor + 1, mSequence, count, payload, mCompress);
+            return count;
+        }
+
+        /*
+            Publisher : snapshot - Encode every replicated value on the board, for resyncing a follower.
+                                   Continue flushing to it from pSequence
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[out] pSequence - Receives the sequence the snapshot reflects
+
+            return std::string - Returns the snapshot frame
+        */
+        inline std::string Publisher::snapshot(uint64_t& pSequence) const {
+
+#ifndef BB_NO_THREAD
+            //Lock the board so the values match the sequence
+            std::lock_guard<std::mutex> guard(mBoard.mDataLock);
+#endif
+
+            pSequence = sequence();
+
+            std::string payload;
+            uint64_t count = 0;
+            for (auto& snapshotter : mSnapshotters) count += snapshotter(payload);
+
+            return Detail::buildFrame(FrameKind::Snapshot, pSequence, pSequence, count, payload, mCompress);
+        }
+
+        /*
+            Publisher : snapshot - Encode every replicated value on the board, for seeding a new follower
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            return std::string - Returns the snapshot frame
+        */
+        inline std::string Publisher::snapshot() const {
+            uint64_t sequence;
+            return snapshot(sequence);
+        }
+
+        /*
+            Publisher : flush - Send everything a follower is missing down a transport, starting with a
+                                snapshot if the follower is too far behind. Never blocks: stops early if
+                                the transport refuses a frame, the rest is sent on the next call
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pTransport - The transport to the follower
+            param[in,out] pCursor - The last sequence sent to the follower, start at 0 for a new follower
+            param[in] pMaxRecords - The most records to put in one frame (Default 256)
+
+            return std::size_t - Returns the number of frames sent
+        */
+        inline std::size_t Publisher::flush(Transport& pTransport, uint64_t& pCursor, std::size_t pMaxRecords) {
+            std::size_t sent = 0;
+            std::string frame;
+
+            //Finish any frame the transport only partly sent last time
+            if (!pTransport.drain()) return sent;
+
+            while (true) {
+                std::size_t count;
+                try {
+                    count = deltasSince(pCursor, frame, pMaxRecords);
+                } catch (const std::out_of_range&) {
+                    //The follower needs a fresh start
+                    uint64_t sequence;
+                    frame = snapshot(sequence);
+                    if (!pTransport.send(frame)) break;
+                    pCursor = sequence;
+                    ++sent;
+                    continue;
+                }
+
+                if (!count || !pTransport.send(frame)) break;
+                pCursor += count;
+                ++sent;
+            }
+            return sent;
+        }
+        #pragma endregion
+
+        #pragma region Follower
+        /*
+            Follower : handler - Find how to apply records of a tag. Throws an invalid_argument exception
+                                 if the type was not registered with replicate<T>
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pTag - The tag read from the record
+
+            return const Handler& - Returns the handler for the tag
+        */
+        inline const Follower::Handler& Follower::handler(uint64_t pTag) const {
+            auto it = mHandlers.find(static_cast<uint32_t>(pTag));
+            if (pTag > 0xFFFFFFFFu || it == mHandlers.end()) throw std::invalid_argument("Replication tag not registered with Follower");
+            return it->second;
+        }
+
+        /*
+            Follower : apply - Apply a frame to the board. Records that were already applied are skipped
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pFrame - A frame built by a Publisher
+
+            return bool - Returns false if the frame is a delta starting after the next expected sequence,
+                          meaning records are missing and a snapshot is needed. Throws a runtime_error or
+                          invalid_argument exception for a malformed frame, leaving the board untouched
+        */
+        inline bool Follower::apply(const std::string& pFrame) {
+            Detail::Reader header(pFrame.data(), pFrame.size());
+            FrameKind kind = static_cast<FrameKind>(header.byte());
+            uint8_t flags = header.byte();
+            uint64_t sequence = header.varint();
+            uint64_t head = header.varint();
+            uint64_t built = header.varint();
+            uint64_t count = header.varint();
+
+            if (kind != FrameKind::Delta && kind != FrameKind::Snapshot) throw std::runtime_error("Unknown replication frame");
+
+            uint64_t applied = this->sequence();
+            if (kind == FrameKind::Delta && (sequence > applied + 1 || needsSnapshot())) {
+                //Records are missing, keep the lag visible until a snapshot arrives
+#ifndef BB_NO_THREAD
+                std::lock_guard<std::mutex> guard(mMetricsLock);
+#endif
+                mMetrics.needsSnapshot = true;
+                if (head > mMetrics.primarySequence) mMetrics.primarySequence = head;
+                mMetrics.recordsBehind = mMetrics.primarySequence > applied ? mMetrics.primarySequence - applied : 0;
+                ++mMetrics.framesRejected;
+                mMetrics.bytesReceived += pFrame.size();
+                return false;
+            }
+
+            //Unpack the payload
+            std::string unpacked;
+            std::size_t size;
+            const char* payload;
+            if (flags & FRAME_COMPRESSED) {
+                uint64_t expected = header.varint();
+                payload = header.rest(size);
+                unpacked = Detail::unpackBits(payload, size, expected);
+                payload = unpacked.data();
+                size = unpacked.size();
+            } else payload = header.rest(size);
+
+            //Parse and check every record before changing the board, so a bad frame leaves it untouched
+            std::vector<std::function<void()>> changes;
+            Detail::Reader reader(payload, size);
+            for (uint64_t i = 0; i < count; ++i) {
+                Op op = static_cast<Op>(reader.byte());
+
+                //Delta records at or before the applied sequence are parsed but not applied again
+                bool skip = kind == FrameKind::Delta && sequence + i <= applied;
+
+                switch (op) {
+                case Op::Write: {
+                    uint64_t tag = reader.varint();
+                    std::string key = reader.string();
+                    std::size_t valueSize;
+                    const char* value = reader.bytes(valueSize);
+                    if (!skip) changes.push_back(handler(tag).write(key, value, valueSize));
+                    break;
+                }
+                case Op::WipeTypeKey: {
+                    uint64_t tag = reader.varint();
+                    std::string key = reader.string();
+                    if (!skip) {
+                        const Handler& wipe = handler(tag);
+                        changes.push_back([&wipe, key]() { wipe.wipe(key); });
+                    }
+                    break;
+                }
+                case Op::WipeKey: {
+                    std::string key = reader.string();
+                    if (!skip) changes.push_back([this, key]() { mBoard.wipeKey(key); });
+                    break;
+                }
+                case Op::WipeBoard:
+                    if (!skip) changes.push_back([this]() { mBoard.wipeBoard(); });
+                    break;
+                default:
+                    throw std::runtime_error("Unknown replication record");
+                }
+            }
+            if (!reader.done()) throw std::runtime_error("Trailing data in replication frame");
+
+            //A snapshot replaces everything on the board
+            if (kind == FrameKind::Snapshot) mBoard.wipeBoard();
+            for (auto& change : changes) change();
+
+            //Update the metrics
+            uint64_t now = Detail::nowMicros();
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mMetricsLock);
+#endif
+            if (kind == FrameKind::Snapshot) {
+                mMetrics.appliedSequence = sequence;
+                mMetrics.needsSnapshot = false;
+                ++mMetrics.snapshotsApplied;
+            } else if (sequence + count > applied + 1) mMetrics.appliedSequence = sequence + count - 1;
+            mMetrics.primarySequence = head;
+            mMetrics.recordsBehind = head > mMetrics.appliedSequence ? head - mMetrics.appliedSequence : 0;
+            mMetrics.delay = std::chrono::microseconds(now > built ? now - built : 0);
+            ++mMetrics.framesApplied;
+            mMetrics.recordsApplied += changes.size();
+            mMetrics.bytesReceived += pFrame.size();
+            return true;
+        }
+
+        /*
+            Follower : poll - Apply every frame currently waiting on a transport. Stops at the first
+                              frame that is rejected for leaving a gap, check needsSnapshot afterwards
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            param[in] pTransport - The transport from the Publisher
+
+            return std::size_t - Returns the number of frames applied
+        */
+        inline std::size_t Follower::poll(Transport& pTransport) {
+            std::size_t applied = 0;
+            std::string frame;
+            while (pTransport.receive(frame)) {
+                if (!apply(frame)) break;
+                ++applied;
+            }
+            return applied;
+        }
+
+        /*
+            Follower : sequence - Get the last sequence applied to the board
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            return uint64_t - Returns the sequence, 0 if nothing was applied yet
+        */
+        inline uint64_t Follower::sequence() const {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mMetricsLock);
+#endif
+            return mMetrics.appliedSequence;
+        }
+
+        /*
+            Follower : needsSnapshot - Check if the follower is stuck behind a gap in the deltas
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            return bool - Returns true until a snapshot has been applied
+        */
+        inline bool Follower::needsSnapshot() const {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mMetricsLock);
+#endif
+            return mMetrics.needsSnapshot;
+        }
+
+        /*
+            Follower : lag - Get how far the board trails the primary, as of the newest frame applied
+            Author: Bricktricker
+            Created: 18/10/2026
+
+            return LagMetrics - Returns a copy of the metrics
+        */
+        inline LagMetrics Follower::lag() const {
+#ifndef BB_NO_THREAD
+            std::lock_guard<std::mutex> guard(mMetricsLock);
+#endif
+            return mMetrics;
+        }
+        #pragma endregion
+    }
+}
+
+#endif